@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    BlockParallelBenchmark.cpp
+
+    Block parallelism against the current chain: long offline blocks of one
+    to sixteen channels, processed by the serial kernel, by ChannelWorkerPool
+    splitting the channels, and by BlockParallelCascade on the pool. The
+    largest deviation from the serial output is checked against the bound
+    documented in BlockParallelCascade.h, both with the default settings
+    and with the worst case that bound is given for.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor.h"
+#include "../Source/ChannelWorkerPool.h"
+#include "../Source/BlockParallelCascade.h"
+
+class BlockParallelBenchmark : public juce::UnitTest
+{
+public:
+    BlockParallelBenchmark() : juce::UnitTest("Block parallel", "Benchmarks") {}
+
+    void runTest() override
+    {
+        // the same FTZ/DAZ mode processBlock runs with
+        const juce::ScopedNoDenormals noDenormals;
+
+        VxT_EQAudioProcessor processor;
+        const auto& k = selectKernels();
+        juce::SharedResourcePointer<ChannelWorkerPool> pool;
+
+        logMessage(juce::String(k.name) + " kernels, " + juce::String(pool->getNumWorkers() + 1) + " threads");
+
+        designCascade(getChainSettings(processor.apvts), 48000.0, coeffs);
+        compare("default settings", k, pool.getObject());
+
+        // the case BlockParallelCascade.h documents: steepest cuts at 20 Hz
+        // and 18 kHz, every peak boosted
+        ChainSettings worst;
+        worst.lowCutF = 20.0f;      worst.lowCutSlope = Slope_48;
+        worst.highCutF = 18000.0f;  worst.highCutSlope = Slope_48;
+        worst.peakF = 200.0f;       worst.peakGain = 12.0f;         worst.peakQ = 1.0f;
+        designCascade(worst, 48000.0, coeffs);
+        compare("48 dB/Oct cuts, all peaks boosted", k, pool.getObject());
+    }
+
+private:
+    void compare(const juce::String& settings, const KernelTable& k, ChannelWorkerPool& pool)
+    {
+        logMessage(settings);
+        logMessage("channels    block   serial ms   channels ms   chunks ms   max error");
+
+        for (int numChannels : { 1, 2, 4, 8, 16 })
+        {
+            for (int blockSize : { 8192, 32768, 131072 })
+            {
+                beginTest(settings + ", " + juce::String(numChannels) + " channels, " + juce::String(blockSize) + " samples");
+
+                juce::AudioBuffer<float> serial, channels, chunked;
+                numFallbacks = 0;
+                const auto serialMs = render(k, Mode::serial, nullptr, numChannels, blockSize, serial);
+                const auto channelsMs = render(k, Mode::serial, &pool, numChannels, blockSize, channels);
+                const auto chunkedMs = render(k, Mode::chunked, &pool, numChannels, blockSize, chunked);
+
+                expectEquals(numFallbacks, 0, "engine refused blocks, the chunked column is serial");
+                const auto error = maxError(serial, chunked);
+                expect(error < 5.0e-4f, "chunked output too far from the serial one");
+
+                logMessage(juce::String(numChannels).paddedLeft(' ', 8)
+                           + juce::String(blockSize).paddedLeft(' ', 9)
+                           + juce::String(serialMs, 1).paddedLeft(' ', 12)
+                           + juce::String(channelsMs, 1).paddedLeft(' ', 14)
+                           + juce::String(chunkedMs, 1).paddedLeft(' ', 12)
+                           + juce::String(error, 6).paddedLeft(' ', 12));
+            }
+        }
+    }
+
+    enum class Mode { serial, chunked };
+
+    // audio per measurement and channel: 16 s at 48 kHz
+    static constexpr int totalSamples = 16 * 48000;
+
+    // processes totalSamples of noise per channel in blocks of blockSize and
+    // returns the elapsed time in ms; the last block's output is left in out.
+    // Serial mode spreads the channels over the pool when one is given,
+    // chunked mode runs the channels one after another like processBlock
+    // and counts the blocks the engine refused.
+    double render(const KernelTable& k, Mode mode, ChannelWorkerPool* pool,
+                  int numChannels, int blockSize, juce::AudioBuffer<float>& out)
+    {
+        juce::AudioBuffer<float> input(numChannels, blockSize);
+        out.setSize(numChannels, blockSize);
+        auto* const* channels = out.getArrayOfWritePointers();
+
+        std::vector<CascadeState> states((size_t)numChannels);
+        BlockParallelCascade engine;
+        engine.prepare(mode == Mode::chunked ? blockSize : 0);
+
+        juce::Random rng(0x5eed);
+        for (int ch = 0; ch < numChannels; ch++)
+            for (int i = 0; i < blockSize; i++)
+                input.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+        auto processChannel = [&](int ch)
+        {
+            auto& state = states[(size_t)ch];
+            juce::FloatVectorOperations::copy(channels[ch], input.getReadPointer(ch), blockSize);
+
+            if (mode == Mode::serial || !engine.process(k, coeffs, state, channels[ch], blockSize, pool))
+            {
+                numFallbacks += mode == Mode::chunked ? 1 : 0;
+                k.processCascade(coeffs, state, channels[ch], blockSize);
+            }
+            state.snapToZero();
+        };
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        for (int block = 0; block < juce::jmax(1, totalSamples / blockSize); block++)
+        {
+            if (mode == Mode::serial && pool != nullptr && pool->tryRun(numChannels, processChannel))
+                continue;
+
+            for (int ch = 0; ch < numChannels; ch++)
+                processChannel(ch);
+        }
+        return juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    // largest difference relative to the reference's peak level
+    static float maxError(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& test)
+    {
+        float peak = 1.0f, err = 0.0f;
+        for (int ch = 0; ch < reference.getNumChannels(); ch++)
+        {
+            for (int i = 0; i < reference.getNumSamples(); i++)
+            {
+                peak = juce::jmax(peak, std::abs(reference.getSample(ch, i)));
+                err = juce::jmax(err, std::abs(reference.getSample(ch, i) - test.getSample(ch, i)));
+            }
+        }
+        return err / peak;
+    }
+
+    CascadeCoeffs coeffs;
+    int numFallbacks{ 0 };
+};
+
+static BlockParallelBenchmark blockParallelBenchmark;
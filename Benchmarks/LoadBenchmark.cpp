@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    LoadBenchmark.cpp
+
+    Session-load cost: instantiate 500 processors and restore each one from
+    a saved state, with the compact format and with the ValueTree blob that
+    builds before it wrote. Instantiating alone is timed as well, so the
+    restore cost is the difference.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor.h"
+
+class LoadBenchmark : public juce::UnitTest
+{
+public:
+    LoadBenchmark() : juce::UnitTest("Load", "Benchmarks") {}
+
+    void runTest() override
+    {
+        VxT_EQAudioProcessor source;
+
+        // move every parameter off its default so each one really is restored
+        for (auto* param : source.getParameters())
+            param->setValueNotifyingHost(0.37f);
+
+        juce::MemoryBlock compact;
+        source.getStateInformation(compact);
+
+        juce::MemoryBlock legacy;
+        {
+            juce::MemoryOutputStream mos(legacy, false);
+            source.apvts.state.writeToStream(mos);
+        }
+
+        beginTest("instantiate only");
+        const auto baseMs = run(source, nullptr);
+
+        beginTest("instantiate + restore, compact state");
+        const auto compactMs = run(source, &compact);
+
+        beginTest("instantiate + restore, legacy ValueTree state");
+        const auto legacyMs = run(source, &legacy);
+
+        logMessage("state size: compact " + juce::String((int)compact.getSize())
+                   + " bytes, legacy " + juce::String((int)legacy.getSize()) + " bytes");
+        logMessage("restore per instance: compact " + juce::String((compactMs - baseMs) * 1000.0 / numInstances, 1)
+                   + " us, legacy " + juce::String((legacyMs - baseMs) * 1000.0 / numInstances, 1) + " us");
+    }
+
+private:
+    static constexpr int numInstances = 500;
+
+    double run(VxT_EQAudioProcessor& source, const juce::MemoryBlock* state)
+    {
+        juce::OwnedArray<VxT_EQAudioProcessor> instances;
+        instances.ensureStorageAllocated(numInstances);
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < numInstances; i++)
+        {
+            auto* p = instances.add(new VxT_EQAudioProcessor());
+            if (state != nullptr)
+                p->setStateInformation(state->getData(), (int)state->getSize());
+        }
+        const auto elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+
+        logMessage(juce::String(numInstances) + " instances: " + juce::String(elapsedMs, 1) + " ms, "
+                   + juce::String(elapsedMs * 1000.0 / numInstances, 1) + " us each");
+
+        if (state != nullptr)
+        {
+            const auto& expected = source.getParameters();
+            const auto& restored = instances.getLast()->getParameters();
+
+            expectEquals(restored.size(), expected.size());
+            for (int i = 0; i < juce::jmin(restored.size(), expected.size()); i++)
+                expectWithinAbsoluteError(restored[i]->getValue(), expected[i]->getValue(), 1.0e-5f);
+        }
+        return elapsedMs;
+    }
+};
+
+static LoadBenchmark loadBenchmark;
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+    Console runner for the performance benchmarks. Builds the plugin's own
+    sources without the plugin wrapper and runs every juce::UnitTest in the
+    "Benchmarks" category, or only the ones whose names are given on the
+    command line. Timings are printed with each test's log; build Release.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::Array<juce::UnitTest*> tests;
+    for (auto* test : juce::UnitTest::getTestsInCategory("Benchmarks"))
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++)
+            selected = selected || test->getName().equalsIgnoreCase(argv[i]);
+
+        if (selected)
+            tests.add(test);
+    }
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTests(tests);
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); i++)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
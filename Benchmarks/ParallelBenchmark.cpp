@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    ParallelBenchmark.cpp
+
+    Channel parallelism. First the cost of one stage on one sample for each
+    kernel the CPU supports, which is what KernelTable::nsPerStageSample
+    holds. Then the speedup of ChannelWorkerPool over the serial channel
+    loop across channel counts and block sizes, next to the estimated block
+    cost and whether the processor's gate, which weighs that cost against
+    the pool's measured dispatch cost, would go parallel. Rows where the
+    gate and the measured speedup disagree show where it is off.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor.h"
+#include "../Source/ChannelWorkerPool.h"
+
+class ParallelBenchmark : public juce::UnitTest
+{
+public:
+    ParallelBenchmark() : juce::UnitTest("Parallel channels", "Benchmarks") {}
+
+    void runTest() override
+    {
+        // the same FTZ/DAZ mode processBlock runs with
+        const juce::ScopedNoDenormals noDenormals;
+
+        VxT_EQAudioProcessor processor;
+        designCascade(getChainSettings(processor.apvts), 48000.0, coeffs);
+
+        beginTest("kernel cost");
+        for (auto isa : { KernelIsa::Scalar, KernelIsa::SSE2, KernelIsa::AVX2, KernelIsa::AVX512, KernelIsa::NEON })
+        {
+            if (!isKernelSupported(isa))
+                continue;
+
+            setKernelOverride(isa);
+            const auto& k = selectKernels();
+            const int blockSize = 8192;
+            const auto ms = render(k, nullptr, 1, blockSize);
+            const auto numSamples = (double)(totalSamples / blockSize) * blockSize;
+
+            logMessage(juce::String(k.name).paddedRight(' ', 8)
+                       + juce::String(ms * 1.0e6 / (numSamples * coeffs.numStages), 2) + " ns per stage and sample");
+        }
+        setKernelOverride(KernelIsa::Auto);
+
+        beginTest("serial vs worker pool");
+        const auto& k = selectKernels();
+        juce::SharedResourcePointer<ChannelWorkerPool> pool;
+
+        logMessage(juce::String(k.name) + " kernels, " + juce::String(pool->getNumWorkers() + 1) + " threads, "
+                   + juce::String(pool->getDispatchCostUs(), 2) + " us dispatch cost");
+        logMessage("channels   block   est. cost us   serial ms   pool ms   speedup   gate");
+
+        double crossoverUs = -1.0;
+        int numMisjudged = 0;
+        for (int numChannels : { 2, 4, 8, 16, 32 })
+        {
+            for (int blockSize : { 32, 128, 512, 2048, 8192 })
+            {
+                const auto serialMs = render(k, nullptr, numChannels, blockSize);
+                const auto poolMs = render(k, &pool.getObject(), numChannels, blockSize);
+                const auto speedup = serialMs / poolMs;
+                const auto costUs = k.nsPerStageSample * coeffs.numStages * blockSize * numChannels / 1000.0;
+
+                // same rule as VxT_EQAudioProcessor::shouldProcessInParallel
+                const auto numThreads = juce::jmin(numChannels, pool->getNumWorkers() + 1);
+                const bool gate = costUs * (1.0 - 1.0 / numThreads) > 2.0 * pool->getDispatchCostUs();
+
+                if (speedup >= 1.1 && (crossoverUs < 0.0 || costUs < crossoverUs))
+                    crossoverUs = costUs;
+                if ((gate && speedup < 0.95) || (!gate && speedup >= 1.1))
+                    numMisjudged++;
+
+                logMessage(juce::String(numChannels).paddedLeft(' ', 8)
+                           + juce::String(blockSize).paddedLeft(' ', 8)
+                           + juce::String(costUs, 1).paddedLeft(' ', 15)
+                           + juce::String(serialMs, 1).paddedLeft(' ', 12)
+                           + juce::String(poolMs, 1).paddedLeft(' ', 10)
+                           + juce::String(speedup, 2).paddedLeft(' ', 10)
+                           + juce::String(gate ? "parallel" : "serial").paddedLeft(' ', 11));
+            }
+        }
+
+        if (crossoverUs < 0.0)
+            logMessage("the pool never gained 10%");
+        else
+            logMessage("smallest estimated block cost gaining 10% or more: " + juce::String(crossoverUs, 1) + " us");
+        logMessage(juce::String(numMisjudged) + " rows where the gate picks the slower path");
+    }
+
+private:
+    // audio per measurement and channel: 4 s at 48 kHz
+    static constexpr int totalSamples = 4 * 48000;
+
+    // runs every channel through the cascade in blocks of blockSize, each
+    // block starting from fresh input like a host's would, and returns the
+    // elapsed time in ms. With a pool, blocks are dispatched the way
+    // processBlock does it.
+    double render(const KernelTable& k, ChannelWorkerPool* pool, int numChannels, int blockSize)
+    {
+        juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+        std::vector<CascadeState> states((size_t)numChannels);
+        auto* const* channels = buffer.getArrayOfWritePointers();
+
+        juce::Random rng(0x5eed);
+        for (int ch = 0; ch < numChannels; ch++)
+            for (int i = 0; i < blockSize; i++)
+                input.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+        auto processChannel = [&](int ch)
+        {
+            juce::FloatVectorOperations::copy(channels[ch], input.getReadPointer(ch), blockSize);
+            k.processCascade(coeffs, states[(size_t)ch], channels[ch], blockSize);
+            states[(size_t)ch].snapToZero();
+        };
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        for (int block = 0; block < totalSamples / blockSize; block++)
+        {
+            if (pool != nullptr && pool->tryRun(numChannels, processChannel))
+                continue;
+
+            for (int ch = 0; ch < numChannels; ch++)
+                processChannel(ch);
+        }
+        return juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    CascadeCoeffs coeffs;
+};
+
+static ParallelBenchmark parallelBenchmark;
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    BlockParallelCascade.cpp
+
+  ==============================================================================
+*/
+
+#include "BlockParallelCascade.h"
+#include "ChannelWorkerPool.h"
+
+void BlockParallelCascade::prepare(int maxBlockSize)
+{
+    maxChunks = juce::jmax(0, (maxBlockSize + chunkLength - 1) / chunkLength);
+
+    chunkEnds.assign((size_t)maxChunks, CascadeState{});
+    chunkStarts.assign((size_t)maxChunks, CascadeState{});
+    scratch.assign((size_t)maxChunks * chunkLength, 0.0f);
+
+    // nothing else is needed while the engine is off, e.g. for realtime use
+    const auto dim = maxChunks > 0 ? (size_t)(2 * CascadeCoeffs::maxStages) : 0;
+    transition.assign(dim * dim, 0.0);
+    tmpA.assign(dim * dim, 0.0);
+    tmpB.assign(dim * dim, 0.0);
+    stitched.assign(dim, 0.0);
+    next.assign(dim, 0.0);
+    transitionValid = false;
+}
+
+bool BlockParallelCascade::canProcess(int numSamples) const noexcept
+{
+    return numSamples >= minBlockSize && (numSamples + chunkLength - 1) / chunkLength <= maxChunks;
+}
+
+static bool sameCoefficients(const CascadeCoeffs& a, const CascadeCoeffs& b)
+{
+    const auto bytes = sizeof(float) * (size_t)a.numStages;
+    return a.numStages == b.numStages
+        && std::memcmp(a.b0, b.b0, bytes) == 0 && std::memcmp(a.b1, b.b1, bytes) == 0
+        && std::memcmp(a.b2, b.b2, bytes) == 0 && std::memcmp(a.a1, b.a1, bytes) == 0
+        && std::memcmp(a.a2, b.a2, bytes) == 0;
+}
+
+// out = a * b, all dim x dim row-major
+static void multiply(const double* a, const double* b, double* out, int dim)
+{
+    for (int r = 0; r < dim; r++)
+    {
+        auto* row = out + r * dim;
+        std::fill(row, row + dim, 0.0);
+
+        for (int k = 0; k < dim; k++)
+        {
+            const auto f = a[r * dim + k];
+            if (f == 0.0)
+                continue;
+            for (int c = 0; c < dim; c++)
+                row[c] += f * b[k * dim + c];
+        }
+    }
+}
+
+void BlockParallelCascade::updateTransition(const CascadeCoeffs& c)
+{
+    if (transitionValid && sameCoefficients(c, cachedCoeffs))
+        return;
+
+    // state vector: s1, s2 of stage 0, then of stage 1, ...
+    const int dim = 2 * c.numStages;
+    auto* phi = tmpA.data();
+
+    // column col is one zero-input step of the cascade from basis state col
+    for (int col = 0; col < dim; col++)
+    {
+        double u = 0.0;
+        for (int s = 0; s < c.numStages; s++)
+        {
+            const double s1 = 2 * s == col ? 1.0 : 0.0;
+            const double s2 = 2 * s + 1 == col ? 1.0 : 0.0;
+
+            const auto y = c.b0[s] * u + s1;
+            phi[(2 * s) * dim + col]     = (c.b1[s] * u - c.a1[s] * y) + s2;
+            phi[(2 * s + 1) * dim + col] = c.b2[s] * u - c.a2[s] * y;
+            u = y;
+        }
+    }
+
+    // chunkLength is a power of two, so Phi^L is just repeated squaring
+    static_assert((chunkLength & (chunkLength - 1)) == 0, "chunkLength must be a power of two");
+    auto* src = tmpA.data();
+    auto* dst = tmpB.data();
+    for (int e = 1; e < chunkLength; e *= 2)
+    {
+        multiply(src, src, dst, dim);
+        std::swap(src, dst);
+    }
+    std::copy(src, src + dim * dim, transition.begin());
+
+    cachedCoeffs = c;
+    transitionValid = true;
+}
+
+bool BlockParallelCascade::process(const KernelTable& k, const CascadeCoeffs& c, CascadeState& st,
+                                   float* x, int numSamples, ChannelWorkerPool* pool)
+{
+    // on one thread both passes together cost about twice the serial
+    // kernel, so only go ahead with the pool held for the whole block
+    if (!canProcess(numSamples) || pool == nullptr || !pool->tryAcquire())
+        return false;
+
+    const int numChunks = (numSamples + chunkLength - 1) / chunkLength;
+
+    updateTransition(c);
+
+    auto chunkSize = [numSamples](int j) { return juce::jmin(chunkLength, numSamples - j * chunkLength); };
+
+    // zero-state responses; chunk 0 starts from the real state and so is
+    // already final, the state it ends in is the true start of chunk 1
+    auto zeroState = [&](int j)
+    {
+        auto& s = chunkEnds[(size_t)j];
+        if (j == 0)
+            s = st;
+        else
+            s.reset();
+        k.processCascade(c, s, x + j * chunkLength, chunkSize(j));
+    };
+    pool->run(numChunks, zeroState);
+
+    // true chunk start states: S[j+1] = Phi^L S[j] + end state of chunk j's zero-state run
+    const int dim = 2 * c.numStages;
+    for (int s = 0; s < c.numStages; s++)
+    {
+        stitched[(size_t)(2 * s)]     = chunkEnds[0].s1[s];
+        stitched[(size_t)(2 * s + 1)] = chunkEnds[0].s2[s];
+    }
+
+    for (int j = 1; j < numChunks; j++)
+    {
+        auto& start = chunkStarts[(size_t)j];
+        for (int s = 0; s < c.numStages; s++)
+        {
+            start.s1[s] = (float)stitched[(size_t)(2 * s)];
+            start.s2[s] = (float)stitched[(size_t)(2 * s + 1)];
+        }
+
+        if (j == numChunks - 1)
+            break;
+
+        const auto& end = chunkEnds[(size_t)j];
+        for (int r = 0; r < dim; r++)
+        {
+            double acc = (r & 1) ? end.s2[r / 2] : end.s1[r / 2];
+            for (int col = 0; col < dim; col++)
+                acc += transition[(size_t)(r * dim + col)] * stitched[(size_t)col];
+            next[(size_t)r] = acc;
+        }
+        std::swap(stitched, next);
+    }
+
+    // add each chunk's zero-input response; the last one also yields the
+    // state the block ends in
+    auto zeroInput = [&](int i)
+    {
+        const int j = i + 1;
+        const int len = chunkSize(j);
+        auto* zir = scratch.data() + (size_t)j * chunkLength;
+        auto* out = x + j * chunkLength;
+
+        std::fill(zir, zir + len, 0.0f);
+        k.processCascade(c, chunkStarts[(size_t)j], zir, len);
+        juce::FloatVectorOperations::add(out, zir, len);
+    };
+    pool->run(numChunks - 1, zeroInput);
+    pool->release();
+
+    const auto& zis = chunkStarts[(size_t)numChunks - 1];
+    const auto& zss = chunkEnds[(size_t)numChunks - 1];
+    for (int s = 0; s < CascadeCoeffs::maxStages; s++)
+    {
+        st.s1[s] = zis.s1[s] + zss.s1[s];
+        st.s2[s] = zis.s2[s] + zss.s2[s];
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    BlockParallelCascade.h
+
+    Offline engine that filters one long block through the cascade in
+    parallel chunks, so even a single channel can use every core.
+
+    The cascade is linear, so each chunk's output is its zero-state response
+    (computed independently, all chunks at once) plus the zero-input response
+    of the state the previous chunks leave behind. Those states are stitched
+    serially with the cascade's state-transition matrix raised to the chunk
+    length, Phi^L, which is cached until the coefficients change. The chunks
+    themselves still run through the selected SIMD kernel.
+
+    The result is not bit-identical to the serial kernel, only as accurate:
+    with 48 dB/Oct cuts at 20 Hz and 18 kHz plus all 16 peaks boosted, both
+    stay within 4e-4 of an exact double evaluation (relative to the signal's
+    peak level) and within 5e-4 of each other. Milder settings are closer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+class ChannelWorkerPool;
+
+class BlockParallelCascade
+{
+public:
+    static constexpr int chunkLength = 2048;
+    // shorter blocks don't split into enough chunks to pay for the second pass
+    static constexpr int minBlockSize = 4 * chunkLength;
+
+    // allocates everything process() needs for blocks up to maxBlockSize
+    void prepare(int maxBlockSize);
+
+    // whether process() takes a block this long: not too short, and
+    // prepared for it
+    bool canProcess(int numSamples) const noexcept;
+
+    // filters x in place and advances state, like KernelTable::processCascade,
+    // running the chunks on pool. Returns false, without touching anything,
+    // if the block is too short, longer than prepared for, or another caller
+    // owns the pool; the caller should then use the serial kernel.
+    bool process(const KernelTable&, const CascadeCoeffs&, CascadeState&,
+                 float* x, int numSamples, ChannelWorkerPool* pool);
+
+private:
+    void updateTransition(const CascadeCoeffs&);
+
+    int maxChunks{ 0 };
+    std::vector<CascadeState> chunkEnds, chunkStarts;
+    std::vector<float> scratch;
+
+    // Phi^L for cachedCoeffs, row-major, 2 * numStages square
+    CascadeCoeffs cachedCoeffs;
+    bool transitionValid{ false };
+    std::vector<double> transition, tmpA, tmpB, stitched, next;
+};
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    ChannelWorkerPool.cpp
+
+  ==============================================================================
+*/
+
+#include "ChannelWorkerPool.h"
+
+struct ChannelWorkerPool::Worker : juce::Thread
+{
+    Worker(ChannelWorkerPool& p, int i)
+        : juce::Thread("VxT_EQ worker " + juce::String(i)), pool(p), index(i)
+    {
+    }
+
+    void run() override { pool.workerLoop(*this); }
+
+    ChannelWorkerPool& pool;
+    const int index;
+    juce::WaitableEvent wake;
+    std::atomic<bool> parked{ false };
+};
+
+static juce::uint64 packRange(int begin, int end)
+{
+    return (juce::uint64)(juce::uint32)begin | ((juce::uint64)(juce::uint32)end << 32);
+}
+
+ChannelWorkerPool::ChannelWorkerPool()
+{
+    // queue 0 belongs to whichever thread calls tryRun
+    numQueues = juce::jlimit(1, maxQueues, juce::SystemStats::getNumCpus());
+
+    for (int i = 1; i < numQueues; i++)
+        workers.add(new Worker(*this, i))->startThread();
+
+    measureDispatchCost();
+}
+
+ChannelWorkerPool::~ChannelWorkerPool()
+{
+    for (auto* w : workers)
+        w->signalThreadShouldExit();
+    for (auto* w : workers)
+    {
+        w->wake.signal();
+        w->stopThread(1000);
+    }
+}
+
+bool ChannelWorkerPool::popFront(int queue, int& task)
+{
+    auto& range = queues[queue].range;
+    auto r = range.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto begin = (int)(juce::uint32)r, end = (int)(juce::uint32)(r >> 32);
+        if (begin >= end)
+            return false;
+        if (range.compare_exchange_weak(r, packRange(begin + 1, end), std::memory_order_acq_rel))
+        {
+            task = begin;
+            return true;
+        }
+    }
+}
+
+bool ChannelWorkerPool::popBack(int queue, int& task)
+{
+    auto& range = queues[queue].range;
+    auto r = range.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto begin = (int)(juce::uint32)r, end = (int)(juce::uint32)(r >> 32);
+        if (begin >= end)
+            return false;
+        if (range.compare_exchange_weak(r, packRange(begin, end - 1), std::memory_order_acq_rel))
+        {
+            task = end - 1;
+            return true;
+        }
+    }
+}
+
+void ChannelWorkerPool::drain(int self)
+{
+    // a successful pop synchronises with tryRun publishing the ranges,
+    // so taskFn and taskCtx are always the ones belonging to that task
+    int task;
+
+    while (popFront(self, task))
+    {
+        taskFn(taskCtx, task);
+        remaining.fetch_sub(1, std::memory_order_release);
+    }
+
+    for (int k = 1; k < numQueues; k++)
+    {
+        const auto victim = (self + k) % numQueues;
+        while (popBack(victim, task))
+        {
+            taskFn(taskCtx, task);
+            remaining.fetch_sub(1, std::memory_order_release);
+        }
+    }
+}
+
+void ChannelWorkerPool::workerLoop(Worker& w)
+{
+    // tasks must see the same FTZ/DAZ mode as the audio thread that posts them
+    const juce::ScopedNoDenormals noDenormals;
+    auto seen = epoch.load(std::memory_order_acquire);
+
+    while (!w.threadShouldExit())
+    {
+        // consecutive blocks of an offline render arrive back to back,
+        // so spin for a while before paying for a wake-up
+        for (int i = 0; i < spinIterations && epoch.load(std::memory_order_acquire) == seen; i++)
+            if ((i & 63) == 63)
+                juce::Thread::yield();
+
+        // then sleep until tryRun or the destructor signals us. tryRun bumps
+        // the epoch before checking parked, we set parked before checking
+        // the epoch: one of us always sees the other
+        while (epoch.load(std::memory_order_acquire) == seen && !w.threadShouldExit())
+        {
+            w.parked.store(true);
+            if (epoch.load() == seen && !w.threadShouldExit())
+                w.wake.wait(-1);
+            w.parked.store(false);
+        }
+
+        seen = epoch.load(std::memory_order_acquire);
+        drain(w.index);
+    }
+}
+
+void ChannelWorkerPool::measureDispatchCost()
+{
+    // back to back, like the blocks of an offline render; the first rounds
+    // only wake the workers up and the median ignores preemption spikes
+    constexpr int numWarmUp = 8, numRounds = 31;
+    auto noop = [](int) {};
+    double roundUs[numRounds];
+
+    for (int i = 0; i < numWarmUp; i++)
+        tryRun(numQueues, noop);
+
+    for (auto& us : roundUs)
+    {
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        tryRun(numQueues, noop);
+        us = (juce::Time::getMillisecondCounterHiRes() - start) * 1000.0;
+    }
+
+    std::nth_element(roundUs, roundUs + numRounds / 2, roundUs + numRounds);
+    dispatchCostUs = roundUs[numRounds / 2];
+}
+
+bool ChannelWorkerPool::tryRun(int numTasks, void (*fn)(void*, int), void* ctx)
+{
+    if (numTasks <= 0)
+        return true;
+    if (!tryAcquire())
+        return false;
+
+    run(numTasks, fn, ctx);
+    release();
+    return true;
+}
+
+void ChannelWorkerPool::run(int numTasks, void (*fn)(void*, int), void* ctx)
+{
+    jassert(busy.load());
+    if (numTasks <= 0)
+        return;
+
+    taskFn = fn;
+    taskCtx = ctx;
+    remaining.store(numTasks, std::memory_order_relaxed);
+
+    for (int q = 0; q < numQueues; q++)
+        queues[q].range.store(packRange(numTasks * q / numQueues, numTasks * (q + 1) / numQueues),
+                              std::memory_order_release);
+
+    epoch.fetch_add(1);
+    for (auto* w : workers)
+        if (w->parked.load())
+            w->wake.signal();
+
+    drain(0);
+
+    // everything is taken, wait for the stragglers still running a task
+    while (remaining.load(std::memory_order_acquire) > 0)
+        juce::Thread::yield();
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    ChannelWorkerPool.h
+
+    Persistent, process-wide pool that runs independent per-channel jobs in
+    parallel. The calling thread takes part in the work; idle workers spin
+    briefly for the next block and then park. Each participant owns a range
+    of jobs and steals from the back of the others' ranges once its own is
+    empty. Dispatching a block allocates nothing.
+
+    Hold it through a juce::SharedResourcePointer so every instance in the
+    process shares the same threads.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class ChannelWorkerPool
+{
+public:
+    ChannelWorkerPool();
+    ~ChannelWorkerPool();
+
+    int getNumWorkers() const noexcept { return workers.size(); }
+
+    // typical time for handing one trivial task to every thread and waiting
+    // for all of them, with the workers awake; measured once at startup
+    double getDispatchCostUs() const noexcept { return dispatchCostUs; }
+
+    // runs task(i) for every i in [0, numTasks) and returns once all have
+    // finished. Returns false, without running anything, if another caller
+    // currently owns the pool; the caller should then do the work itself.
+    template<typename Task>
+    bool tryRun(int numTasks, Task& task)
+    {
+        return tryRun(numTasks, [](void* ctx, int i) { (*static_cast<Task*>(ctx))(i); }, &task);
+    }
+
+    bool tryRun(int numTasks, void (*fn)(void*, int), void* ctx);
+
+    // claims the pool for several run() calls in a row, e.g. the passes of
+    // one block; false if another caller owns it. Pair with release().
+    bool tryAcquire() noexcept { return !busy.exchange(true, std::memory_order_acquire); }
+    void release() noexcept { busy.store(false, std::memory_order_release); }
+
+    // like tryRun, for a caller that has acquired the pool
+    template<typename Task>
+    void run(int numTasks, Task& task)
+    {
+        run(numTasks, [](void* ctx, int i) { (*static_cast<Task*>(ctx))(i); }, &task);
+    }
+
+    void run(int numTasks, void (*fn)(void*, int), void* ctx);
+
+private:
+    struct Worker;
+    struct alignas(64) Queue
+    {
+        // begin in the low half, end in the high half, so the owner popping
+        // the front and a thief popping the back race on a single word
+        std::atomic<juce::uint64> range{ 0 };
+    };
+
+    static constexpr int maxQueues = 16;
+    static constexpr int spinIterations = 4000;
+
+    bool popFront(int queue, int& task);
+    bool popBack(int queue, int& task);
+    void drain(int self);
+    void workerLoop(Worker&);
+    void measureDispatchCost();
+
+    juce::OwnedArray<Worker> workers;
+    Queue queues[maxQueues];
+    int numQueues{ 1 };
+
+    void (*taskFn)(void*, int){ nullptr };
+    void* taskCtx{ nullptr };
+    std::atomic<int> remaining{ 0 };
+    std::atomic<juce::uint32> epoch{ 0 };
+    std::atomic<bool> busy{ false };
+    double dispatchCostUs{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelWorkerPool)
+};
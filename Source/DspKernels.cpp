@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    DspKernels.cpp
+
+    Scalar reference kernels and runtime dispatch.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+void CascadeCoeffs::setIdentity(int stage) noexcept
+{
+    b0[stage] = 1.0f;
+    b1[stage] = b2[stage] = a1[stage] = a2[stage] = 0.0f;
+}
+
+void CascadeCoeffs::clear() noexcept
+{
+    numStages = 0;
+    for (int i = 0; i < maxStages; i++)
+        setIdentity(i);
+}
+
+void CascadeState::reset() noexcept
+{
+    std::fill(std::begin(s1), std::end(s1), 0.0f);
+    std::fill(std::begin(s2), std::end(s2), 0.0f);
+}
+
+void CascadeState::snapToZero() noexcept
+{
+    for (int i = 0; i < CascadeCoeffs::maxStages; i++)
+    {
+        JUCE_SNAP_TO_ZERO(s1[i]);
+        JUCE_SNAP_TO_ZERO(s2[i]);
+    }
+}
+
+//==============================================================================
+// Every SIMD kernel must match these bit for bit, so multiply-adds stay
+// unfused here and in each kernel unit. GCC fuses by default wherever FMA
+// is available, i.e. always on AArch64 and with -mfma or -march=native on
+// x86; Clang and MSVC fuse within an expression when asked to.
+#if defined(__clang__)
+ #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+ #pragma fp_contract(off)
+#endif
+
+// same arithmetic as juce::dsp::IIR::Filter::processSamples, one stage at a time
+void processCascadeScalar(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    for (int s = 0; s < c.numStages; s++)
+    {
+        const auto b0 = c.b0[s], b1 = c.b1[s], b2 = c.b2[s], a1 = c.a1[s], a2 = c.a2[s];
+        auto s1 = st.s1[s], s2 = st.s2[s];
+
+        for (int i = 0; i < n; i++)
+        {
+            const auto in = x[i];
+            const auto out = b0 * in + s1;
+            s1 = (b1 * in - a1 * out) + s2;
+            s2 = b2 * in - a2 * out;
+            x[i] = out;
+        }
+
+        st.s1[s] = s1;
+        st.s2[s] = s2;
+    }
+}
+
+void cascadeMagnitudesScalar(const CascadeCoeffs& c,
+                             const double* cosW, const double* sinW,
+                             const double* cos2W, const double* sin2W,
+                             double* mags, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        double m2 = 1.0;
+
+        for (int s = 0; s < c.numStages; s++)
+        {
+            const double b0 = c.b0[s], b1 = c.b1[s], b2 = c.b2[s], a1 = c.a1[s], a2 = c.a2[s];
+
+            const auto nr = b0 + (b1 * cosW[i] + b2 * cos2W[i]);
+            const auto ni = b1 * sinW[i] + b2 * sin2W[i];
+            const auto dr = 1.0 + (a1 * cosW[i] + a2 * cos2W[i]);
+            const auto di = a1 * sinW[i] + a2 * sin2W[i];
+
+            m2 *= (nr * nr + ni * ni) / (dr * dr + di * di);
+        }
+        mags[i] = std::sqrt(m2);
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+ #pragma GCC pop_options
+#endif
+
+//==============================================================================
+static const KernelTable scalarKernels{ KernelIsa::Scalar, "scalar", 5.0f, processCascadeScalar, cascadeMagnitudesScalar };
+#if VXT_KERNELS_X86
+static const KernelTable sse2Kernels{ KernelIsa::SSE2, "sse2", 1.4f, processCascadeSSE2, cascadeMagnitudesSSE2 };
+static const KernelTable avx2Kernels{ KernelIsa::AVX2, "avx2", 0.85f, processCascadeAVX2, cascadeMagnitudesAVX2 };
+static const KernelTable avx512Kernels{ KernelIsa::AVX512, "avx512", 0.65f, processCascadeAVX512, cascadeMagnitudesAVX512 };
+#endif
+#if VXT_KERNELS_NEON
+static const KernelTable neonKernels{ KernelIsa::NEON, "neon", 1.4f, processCascadeNEON, cascadeMagnitudesNEON };
+#endif
+
+static std::atomic<KernelIsa> kernelOverride{ KernelIsa::Auto };
+
+static const KernelTable* findKernels(KernelIsa isa)
+{
+    switch (isa)
+    {
+        case KernelIsa::Scalar:     return &scalarKernels;
+       #if VXT_KERNELS_X86
+        case KernelIsa::SSE2:       return &sse2Kernels;
+        case KernelIsa::AVX2:       return &avx2Kernels;
+        case KernelIsa::AVX512:     return &avx512Kernels;
+       #endif
+       #if VXT_KERNELS_NEON
+        case KernelIsa::NEON:       return &neonKernels;
+       #endif
+        default:                    return nullptr;
+    }
+}
+
+bool isKernelSupported(KernelIsa isa)
+{
+    if (findKernels(isa) == nullptr)
+        return false;
+
+    switch (isa)
+    {
+        case KernelIsa::SSE2:       return juce::SystemStats::hasSSE2();
+        case KernelIsa::AVX2:       return juce::SystemStats::hasAVX2();
+        case KernelIsa::AVX512:     return juce::SystemStats::hasAVX512F();
+        case KernelIsa::NEON:       return juce::SystemStats::hasNeon();
+        default:                    return true;
+    }
+}
+
+static KernelIsa parseKernelName(const juce::String& name)
+{
+    for (auto isa : { KernelIsa::Scalar, KernelIsa::SSE2, KernelIsa::AVX2, KernelIsa::AVX512, KernelIsa::NEON })
+        if (auto* k = findKernels(isa); k != nullptr && name.equalsIgnoreCase(k->name))
+            return isa;
+    return KernelIsa::Auto;
+}
+
+const KernelTable& selectKernels()
+{
+    auto requested = kernelOverride.load();
+    if (requested == KernelIsa::Auto)
+        requested = parseKernelName(juce::SystemStats::getEnvironmentVariable("VXT_EQ_KERNEL", {}).trim());
+
+    if (requested != KernelIsa::Auto && isKernelSupported(requested))
+        return *findKernels(requested);
+
+    for (auto isa : { KernelIsa::AVX512, KernelIsa::AVX2, KernelIsa::SSE2, KernelIsa::NEON })
+        if (isKernelSupported(isa))
+            return *findKernels(isa);
+
+    return scalarKernels;
+}
+
+const KernelTable& getScalarKernels()
+{
+    return scalarKernels;
+}
+
+void setKernelOverride(KernelIsa isa)
+{
+    kernelOverride = isa;
+}
+
+float verifyKernels(const KernelTable& k, const CascadeCoeffs& c)
+{
+    constexpr int numSamples = 1031; // odd length, exercises the partial steps
+    std::vector<float> ref(numSamples), test(numSamples);
+
+    juce::Random rng(0x5eed);
+    for (auto& v : ref)
+        v = rng.nextFloat() * 2.0f - 1.0f;
+    test = ref;
+
+    CascadeState refState, testState;
+    refState.reset();
+    testState.reset();
+
+    // two calls each, so state carried across blocks is checked too
+    const int split = numSamples / 2;
+    processCascadeScalar(c, refState, ref.data(), split);
+    processCascadeScalar(c, refState, ref.data() + split, numSamples - split);
+    k.processCascade(c, testState, test.data(), split);
+    k.processCascade(c, testState, test.data() + split, numSamples - split);
+
+    float peak = 1.0f, err = 0.0f;
+    for (int i = 0; i < numSamples; i++)
+    {
+        peak = juce::jmax(peak, std::abs(ref[i]));
+        err = juce::jmax(err, std::abs(ref[i] - test[i]));
+    }
+    return err / peak;
+}
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    DspKernels.h
+
+    ISA-specific kernels for the biquad cascade and its response curve.
+    Every variant is compiled into the binary; the best one the CPU supports
+    is picked at runtime by selectKernels().
+
+    This header is deliberately JUCE-free: it is included by the per-ISA
+    translation units, which are compiled with wider target options than
+    the rest of the plugin.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define VXT_KERNELS_X86 1
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+ #define VXT_KERNELS_NEON 1
+#endif
+
+enum class KernelIsa { Auto, Scalar, SSE2, AVX2, AVX512, NEON };
+
+// flattened, normalised (a0 == 1) second-order sections in processing order,
+// stored as structure-of-arrays so a kernel can load one coefficient for
+// several stages at once. Unused entries up to maxStages are identity stages.
+struct CascadeCoeffs
+{
+    static constexpr int maxStages = 32;
+
+    int numStages{ 0 };
+    alignas(64) float b0[maxStages];
+    alignas(64) float b1[maxStages];
+    alignas(64) float b2[maxStages];
+    alignas(64) float a1[maxStages];
+    alignas(64) float a2[maxStages];
+
+    void setIdentity(int stage) noexcept;
+    void clear() noexcept;
+};
+
+// transposed direct form II state, one cascade per channel
+struct CascadeState
+{
+    alignas(64) float s1[CascadeCoeffs::maxStages]{};
+    alignas(64) float s2[CascadeCoeffs::maxStages]{};
+
+    void reset() noexcept;
+    void snapToZero() noexcept;
+};
+
+struct KernelTable
+{
+    KernelIsa isa;
+    const char* name;
+
+    // rough cost of one stage on one sample, in ns; only used to decide
+    // whether a block is worth splitting across threads. The x86 figures
+    // were timed with a standalone harness around these kernels (median of
+    // three runs, 8192-sample blocks, 24 stages, one x86-64 Xeon VM, GCC 12
+    // -O2), the same measurement as the "Parallel channels" benchmark's
+    // kernel cost test. NEON has not been measured and borrows SSE2's.
+    float nsPerStageSample;
+
+    // filters numSamples samples in place through every stage
+    void (*processCascade)(const CascadeCoeffs&, CascadeState&, float* samples, int numSamples);
+
+    // linear magnitude of the whole cascade at each normalised frequency w,
+    // given cos(w), sin(w), cos(2w) and sin(2w)
+    void (*cascadeMagnitudes)(const CascadeCoeffs&,
+                              const double* cosW, const double* sinW,
+                              const double* cos2W, const double* sin2W,
+                              double* magnitudes, int num);
+};
+
+// picks the override if one is set and supported, else the VXT_EQ_KERNEL
+// environment variable (scalar, sse2, avx2, avx512, neon), else the best ISA
+const KernelTable& selectKernels();
+const KernelTable& getScalarKernels();
+bool isKernelSupported(KernelIsa);
+
+// A/B switch for benchmarking; KernelIsa::Auto restores automatic selection.
+// Takes effect the next time selectKernels() is called (i.e. prepareToPlay).
+void setKernelOverride(KernelIsa);
+
+// runs the kernel and the scalar reference over the same noise and returns
+// the largest difference, relative to the reference's peak level
+float verifyKernels(const KernelTable&, const CascadeCoeffs&);
+
+// per-ISA entry points, only the ones matching the target are compiled
+void processCascadeScalar(const CascadeCoeffs&, CascadeState&, float*, int);
+void cascadeMagnitudesScalar(const CascadeCoeffs&, const double*, const double*, const double*, const double*, double*, int);
+
+#if VXT_KERNELS_X86
+void processCascadeSSE2(const CascadeCoeffs&, CascadeState&, float*, int);
+void cascadeMagnitudesSSE2(const CascadeCoeffs&, const double*, const double*, const double*, const double*, double*, int);
+void processCascadeAVX2(const CascadeCoeffs&, CascadeState&, float*, int);
+void cascadeMagnitudesAVX2(const CascadeCoeffs&, const double*, const double*, const double*, const double*, double*, int);
+void processCascadeAVX512(const CascadeCoeffs&, CascadeState&, float*, int);
+void cascadeMagnitudesAVX512(const CascadeCoeffs&, const double*, const double*, const double*, const double*, double*, int);
+#endif
+
+#if VXT_KERNELS_NEON
+void processCascadeNEON(const CascadeCoeffs&, CascadeState&, float*, int);
+void cascadeMagnitudesNEON(const CascadeCoeffs&, const double*, const double*, const double*, const double*, double*, int);
+#endif
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    DspKernelsImpl.h
+
+    Kernel bodies shared by the per-ISA translation units. Each unit defines
+    an Ops struct for float lanes and a DOps struct for double lanes and
+    instantiates the templates below with them, so every instantiation is a
+    distinct symbol compiled with its own target options.
+
+    Only include this from a DspKernels_*.cpp file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspKernels.h"
+
+// The cascade is evaluated as a wavefront: lane k of the vector holds stage
+// k of the current group, working on sample t - k. Each step every stage
+// runs one transposed direct form II update, then the outputs move up one
+// lane to become the next stage's input. The per-stage arithmetic is the
+// same as in the scalar reference, only the order across stages differs.
+template<typename Ops, bool masked>
+static inline void cascadeStep(typename Ops::V& y, typename Ops::V& s1, typename Ops::V& s2,
+                               const typename Ops::V* k, typename Ops::V laneIdx,
+                               float* x, int n, int t)
+{
+    constexpr int L = Ops::lanes;
+    const auto in = Ops::shiftIn(y, t < n ? x[t] : 0.0f);
+
+    y = Ops::add(Ops::mul(k[0], in), s1);
+    const auto n1 = Ops::add(Ops::sub(Ops::mul(k[1], in), Ops::mul(k[3], y)), s2);
+    const auto n2 = Ops::sub(Ops::mul(k[2], in), Ops::mul(k[4], y));
+
+    if constexpr (masked)
+    {
+        // stages whose input hasn't arrived yet, or has already run out
+        const auto active = Ops::activeMask(laneIdx, float(t - n), float(t));
+        s1 = Ops::select(active, n1, s1);
+        s2 = Ops::select(active, n2, s2);
+    }
+    else
+    {
+        s1 = n1;
+        s2 = n2;
+    }
+
+    if (t >= L - 1)
+        x[t - (L - 1)] = Ops::lastLane(y);
+}
+
+template<typename Ops>
+static inline void processGroup(const CascadeCoeffs& c, CascadeState& st, int first,
+                                float* x, int n)
+{
+    constexpr int L = Ops::lanes;
+
+    // b0, b1, b2, a1, a2
+    const typename Ops::V k[5] = {
+        Ops::load(c.b0 + first), Ops::load(c.b1 + first), Ops::load(c.b2 + first),
+        Ops::load(c.a1 + first), Ops::load(c.a2 + first)
+    };
+    auto s1 = Ops::load(st.s1 + first), s2 = Ops::load(st.s2 + first);
+    auto y = Ops::set1(0.0f);
+
+    const auto laneIdx = Ops::laneIndex();
+    const int steps = n + L - 1;
+
+    int t = 0;
+    for (; t < steps && t < L - 1; ++t)
+        cascadeStep<Ops, true>(y, s1, s2, k, laneIdx, x, n, t);
+    for (; t < n; ++t)
+        cascadeStep<Ops, false>(y, s1, s2, k, laneIdx, x, n, t);
+    for (; t < steps; ++t)
+        cascadeStep<Ops, true>(y, s1, s2, k, laneIdx, x, n, t);
+
+    Ops::store(st.s1 + first, s1);
+    Ops::store(st.s2 + first, s2);
+}
+
+template<typename Ops>
+static void processCascadeImpl(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    // too short to fill the pipeline, the per-stage loops are cheaper
+    if (n < Ops::lanes)
+        return processCascadeScalar(c, st, x, n);
+
+    for (int first = 0; first < c.numStages; first += Ops::lanes)
+        processGroup<Ops>(c, st, first, x, n);
+}
+
+template<typename DOps>
+static void cascadeMagnitudesImpl(const CascadeCoeffs& c,
+                                  const double* cosW, const double* sinW,
+                                  const double* cos2W, const double* sin2W,
+                                  double* mags, int num)
+{
+    constexpr int L = DOps::lanes;
+    int i = 0;
+
+    for (; i + L <= num; i += L)
+    {
+        const auto c1 = DOps::load(cosW + i), s1 = DOps::load(sinW + i);
+        const auto c2 = DOps::load(cos2W + i), s2 = DOps::load(sin2W + i);
+        const auto one = DOps::set1(1.0);
+        auto m2 = one;
+
+        for (int s = 0; s < c.numStages; ++s)
+        {
+            const auto b0 = DOps::set1(c.b0[s]), b1 = DOps::set1(c.b1[s]), b2 = DOps::set1(c.b2[s]);
+            const auto a1 = DOps::set1(c.a1[s]), a2 = DOps::set1(c.a2[s]);
+
+            const auto nr = DOps::add(b0, DOps::add(DOps::mul(b1, c1), DOps::mul(b2, c2)));
+            const auto ni = DOps::add(DOps::mul(b1, s1), DOps::mul(b2, s2));
+            const auto dr = DOps::add(one, DOps::add(DOps::mul(a1, c1), DOps::mul(a2, c2)));
+            const auto di = DOps::add(DOps::mul(a1, s1), DOps::mul(a2, s2));
+
+            const auto num2 = DOps::add(DOps::mul(nr, nr), DOps::mul(ni, ni));
+            const auto den2 = DOps::add(DOps::mul(dr, dr), DOps::mul(di, di));
+            m2 = DOps::mul(m2, DOps::div(num2, den2));
+        }
+        DOps::store(mags + i, DOps::sqrt(m2));
+    }
+
+    if (i < num)
+        cascadeMagnitudesScalar(c, cosW + i, sinW + i, cos2W + i, sin2W + i, mags + i, num - i);
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX2.cpp
+
+    Only reached when the CPU reports AVX2, see selectKernels().
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if VXT_KERNELS_X86
+
+#include <immintrin.h>
+
+// MSVC emits any intrinsic without extra flags; GCC and Clang need the
+// target enabled for this unit only. Nothing from JUCE or the standard
+// library may be included below this point. Multiply-adds stay unfused,
+// see DspKernels.cpp.
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+ #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("avx2")
+ #pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+ #pragma fp_contract(off)
+#endif
+
+#include "DspKernelsImpl.h"
+
+namespace
+{
+    struct Ops
+    {
+        using V = __m256;
+        using M = __m256;
+        static constexpr int lanes = 8;
+
+        static V load(const float* p)         { return _mm256_loadu_ps(p); }
+        static void store(float* p, V v)      { _mm256_storeu_ps(p, v); }
+        static V set1(float v)                { return _mm256_set1_ps(v); }
+        static V add(V a, V b)                { return _mm256_add_ps(a, b); }
+        static V sub(V a, V b)                { return _mm256_sub_ps(a, b); }
+        static V mul(V a, V b)                { return _mm256_mul_ps(a, b); }
+        static V laneIndex()                  { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+
+        static M activeMask(V idx, float lo, float hi)
+        {
+            return _mm256_and_ps(_mm256_cmp_ps(idx, _mm256_set1_ps(lo), _CMP_GT_OQ),
+                                 _mm256_cmp_ps(idx, _mm256_set1_ps(hi), _CMP_LE_OQ));
+        }
+        static V select(M m, V a, V b)        { return _mm256_blendv_ps(b, a, m); }
+
+        static V shiftIn(V y, float in)
+        {
+            const auto up = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+            return _mm256_blend_ps(up, _mm256_set1_ps(in), 1);
+        }
+        static float lastLane(V y)
+        {
+            const auto hi = _mm256_extractf128_ps(y, 1);
+            return _mm_cvtss_f32(_mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+    };
+
+    struct DOps
+    {
+        using V = __m256d;
+        static constexpr int lanes = 4;
+
+        static V load(const double* p)        { return _mm256_loadu_pd(p); }
+        static void store(double* p, V v)     { _mm256_storeu_pd(p, v); }
+        static V set1(double v)               { return _mm256_set1_pd(v); }
+        static V add(V a, V b)                { return _mm256_add_pd(a, b); }
+        static V mul(V a, V b)                { return _mm256_mul_pd(a, b); }
+        static V div(V a, V b)                { return _mm256_div_pd(a, b); }
+        static V sqrt(V a)                    { return _mm256_sqrt_pd(a); }
+    };
+}
+
+void processCascadeAVX2(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    processCascadeImpl<Ops>(c, st, x, n);
+}
+
+void cascadeMagnitudesAVX2(const CascadeCoeffs& c, const double* cw, const double* sw,
+                           const double* c2w, const double* s2w, double* mags, int num)
+{
+    cascadeMagnitudesImpl<DOps>(c, cw, sw, c2w, s2w, mags, num);
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
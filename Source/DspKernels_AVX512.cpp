@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX512.cpp
+
+    Only reached when the CPU reports AVX-512F, see selectKernels().
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if VXT_KERNELS_X86
+
+#include <immintrin.h>
+
+// see DspKernels_AVX2.cpp. AVX-512F implies FMA, so GCC would fuse the
+// multiply-adds here even without -mfma, see DspKernels.cpp.
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+ #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("avx512f")
+ #pragma GCC optimize("fp-contract=off")
+ #pragma GCC diagnostic push
+ #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#elif defined(_MSC_VER)
+ #pragma fp_contract(off)
+#endif
+
+#include "DspKernelsImpl.h"
+
+namespace
+{
+    struct Ops
+    {
+        using V = __m512;
+        using M = __mmask16;
+        static constexpr int lanes = 16;
+
+        static V load(const float* p)         { return _mm512_loadu_ps(p); }
+        static void store(float* p, V v)      { _mm512_storeu_ps(p, v); }
+        static V set1(float v)                { return _mm512_set1_ps(v); }
+        static V add(V a, V b)                { return _mm512_add_ps(a, b); }
+        static V sub(V a, V b)                { return _mm512_sub_ps(a, b); }
+        static V mul(V a, V b)                { return _mm512_mul_ps(a, b); }
+        static V laneIndex()
+        {
+            return _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+                                  8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+        }
+
+        static M activeMask(V idx, float lo, float hi)
+        {
+            return _mm512_cmp_ps_mask(idx, _mm512_set1_ps(lo), _CMP_GT_OQ)
+                 & _mm512_cmp_ps_mask(idx, _mm512_set1_ps(hi), _CMP_LE_OQ);
+        }
+        static V select(M m, V a, V b)        { return _mm512_mask_blend_ps(m, b, a); }
+
+        static V shiftIn(V y, float in)
+        {
+            const auto idx = _mm512_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+            return _mm512_mask_mov_ps(_mm512_permutexvar_ps(idx, y), 1, _mm512_set1_ps(in));
+        }
+        static float lastLane(V y)
+        {
+            const auto hi = _mm512_extractf32x4_ps(y, 3);
+            return _mm_cvtss_f32(_mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+    };
+
+    struct DOps
+    {
+        using V = __m512d;
+        static constexpr int lanes = 8;
+
+        static V load(const double* p)        { return _mm512_loadu_pd(p); }
+        static void store(double* p, V v)     { _mm512_storeu_pd(p, v); }
+        static V set1(double v)               { return _mm512_set1_pd(v); }
+        static V add(V a, V b)                { return _mm512_add_pd(a, b); }
+        static V mul(V a, V b)                { return _mm512_mul_pd(a, b); }
+        static V div(V a, V b)                { return _mm512_div_pd(a, b); }
+        static V sqrt(V a)                    { return _mm512_sqrt_pd(a); }
+    };
+}
+
+void processCascadeAVX512(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    processCascadeImpl<Ops>(c, st, x, n);
+}
+
+void cascadeMagnitudesAVX512(const CascadeCoeffs& c, const double* cw, const double* sw,
+                             const double* c2w, const double* s2w, double* mags, int num)
+{
+    cascadeMagnitudesImpl<DOps>(c, cw, sw, c2w, s2w, mags, num);
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC diagnostic pop
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DspKernels_NEON.cpp
+
+    AArch64 only; NEON is part of the baseline there so no target options
+    are needed, but GCC fuses vmulq/vaddq pairs into FMA by default.
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if VXT_KERNELS_NEON
+
+#include <arm_neon.h>
+
+// keep the multiply-adds unfused so results stay identical to the scalar
+// reference, see DspKernels.cpp
+#if defined(__clang__)
+ #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+ #pragma fp_contract(off)
+#endif
+
+#include "DspKernelsImpl.h"
+
+namespace
+{
+    struct Ops
+    {
+        using V = float32x4_t;
+        using M = uint32x4_t;
+        static constexpr int lanes = 4;
+
+        static V load(const float* p)         { return vld1q_f32(p); }
+        static void store(float* p, V v)      { vst1q_f32(p, v); }
+        static V set1(float v)                { return vdupq_n_f32(v); }
+        static V add(V a, V b)                { return vaddq_f32(a, b); }
+        static V sub(V a, V b)                { return vsubq_f32(a, b); }
+        static V mul(V a, V b)                { return vmulq_f32(a, b); }
+        static V laneIndex()
+        {
+            static const float idx[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+            return vld1q_f32(idx);
+        }
+
+        static M activeMask(V idx, float lo, float hi)
+        {
+            return vandq_u32(vcgtq_f32(idx, vdupq_n_f32(lo)), vcleq_f32(idx, vdupq_n_f32(hi)));
+        }
+        static V select(M m, V a, V b)        { return vbslq_f32(m, a, b); }
+
+        // { in, y0, y1, y2 }
+        static V shiftIn(V y, float in)       { return vextq_f32(vdupq_n_f32(in), y, 3); }
+        static float lastLane(V y)            { return vgetq_lane_f32(y, 3); }
+    };
+
+    struct DOps
+    {
+        using V = float64x2_t;
+        static constexpr int lanes = 2;
+
+        static V load(const double* p)        { return vld1q_f64(p); }
+        static void store(double* p, V v)     { vst1q_f64(p, v); }
+        static V set1(double v)               { return vdupq_n_f64(v); }
+        static V add(V a, V b)                { return vaddq_f64(a, b); }
+        static V mul(V a, V b)                { return vmulq_f64(a, b); }
+        static V div(V a, V b)                { return vdivq_f64(a, b); }
+        static V sqrt(V a)                    { return vsqrtq_f64(a); }
+    };
+}
+
+void processCascadeNEON(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    processCascadeImpl<Ops>(c, st, x, n);
+}
+
+void cascadeMagnitudesNEON(const CascadeCoeffs& c, const double* cw, const double* sw,
+                           const double* c2w, const double* s2w, double* mags, int num)
+{
+    cascadeMagnitudesImpl<DOps>(c, cw, sw, c2w, s2w, mags, num);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    DspKernels_SSE2.cpp
+
+    SSE2 is part of the x86-64 baseline, but not of 32-bit x86.
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if VXT_KERNELS_X86
+
+#include <emmintrin.h>
+
+// see DspKernels_AVX2.cpp; the target is only needed for 32-bit builds
+// without -msse2
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+ #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("sse2")
+ #pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+ #pragma fp_contract(off)
+#endif
+
+#include "DspKernelsImpl.h"
+
+namespace
+{
+    struct Ops
+    {
+        using V = __m128;
+        using M = __m128;
+        static constexpr int lanes = 4;
+
+        static V load(const float* p)         { return _mm_loadu_ps(p); }
+        static void store(float* p, V v)      { _mm_storeu_ps(p, v); }
+        static V set1(float v)                { return _mm_set1_ps(v); }
+        static V add(V a, V b)                { return _mm_add_ps(a, b); }
+        static V sub(V a, V b)                { return _mm_sub_ps(a, b); }
+        static V mul(V a, V b)                { return _mm_mul_ps(a, b); }
+        static V laneIndex()                  { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+
+        static M activeMask(V idx, float lo, float hi)
+        {
+            return _mm_and_ps(_mm_cmpgt_ps(idx, _mm_set1_ps(lo)), _mm_cmple_ps(idx, _mm_set1_ps(hi)));
+        }
+        static V select(M m, V a, V b)        { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+        static V shiftIn(V y, float in)
+        {
+            const auto up = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(y), 4));
+            return _mm_move_ss(up, _mm_set_ss(in));
+        }
+        static float lastLane(V y)            { return _mm_cvtss_f32(_mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3))); }
+    };
+
+    struct DOps
+    {
+        using V = __m128d;
+        static constexpr int lanes = 2;
+
+        static V load(const double* p)        { return _mm_loadu_pd(p); }
+        static void store(double* p, V v)     { _mm_storeu_pd(p, v); }
+        static V set1(double v)               { return _mm_set1_pd(v); }
+        static V add(V a, V b)                { return _mm_add_pd(a, b); }
+        static V mul(V a, V b)                { return _mm_mul_pd(a, b); }
+        static V div(V a, V b)                { return _mm_div_pd(a, b); }
+        static V sqrt(V a)                    { return _mm_sqrt_pd(a); }
+    };
+}
+
+void processCascadeSSE2(const CascadeCoeffs& c, CascadeState& st, float* x, int n)
+{
+    processCascadeImpl<Ops>(c, st, x, n);
+}
+
+void cascadeMagnitudesSSE2(const CascadeCoeffs& c, const double* cw, const double* sw,
+                           const double* c2w, const double* s2w, double* mags, int num)
+{
+    cascadeMagnitudesImpl<DOps>(c, cw, sw, c2w, s2w, mags, num);
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -14,47 +14,68 @@ RespCurveComponent::RespCurveComponent(VxT_EQAudioProcessor& p) : audioProcessor
     for (auto param : audioProcessor.getParameters())
         param->addListener(this);
 
-    startTimerHz(60);
+    scheduler->addClient(*this);
 }
 
 RespCurveComponent::~RespCurveComponent()
 {
     for (auto param : audioProcessor.getParameters())
         param->removeListener(this);
+
+    scheduler->removeClient(*this);
 }
 
 void RespCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
 {
-    paramChanged.set(true);
+    scheduler->requestFrame(*this);
 }
 
-void RespCurveComponent::timerCallback()
+void RespCurveComponent::visibilityChanged()
 {
-    if (paramChanged.compareAndSetBool(false, true))
-    {
-        updateFilters(getChainSettings(audioProcessor.apvts), audioProcessor.getSampleRate(), respChain);
-        repaint();
-    }
+    scheduler->clientVisibilityChanged();
+}
+
+void RespCurveComponent::parentHierarchyChanged()
+{
+    scheduler->clientVisibilityChanged();
 }
 
-template<int Idx>
-inline double RespCurveComponent::calcPeakMagnitude(peakFilter& chain, const double freq, const double sampleRate)
+void RespCurveComponent::renderFrame()
 {
-    auto m = chain.get<Idx-1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-    return m * calcPeakMagnitude<Idx - 1>(chain, freq, sampleRate);
+    refreshChain();
+    repaint();
 }
-// specialized exit template
-template<>
-double RespCurveComponent::calcPeakMagnitude<0>(peakFilter& chain, const double freq, const double sampleRate)
+
+bool RespCurveComponent::isStale()
 {
-    return 1.0;
+    // the editor can open before the host has prepared the processor, and
+    // hosts can change the rate later; neither touches a parameter
+    return audioProcessor.getSampleRate() != respSampleRate;
 }
 
+void RespCurveComponent::refreshChain()
+{
+    const auto sampleRate = audioProcessor.getSampleRate();
+    respSampleRate = sampleRate;
+
+    if (sampleRate <= 0.0)
+    {
+        respCascade.clear();
+        return;
+    }
+    designCascade(getChainSettings(audioProcessor.apvts), sampleRate, respCascade);
+}
 
 void RespCurveComponent::paint(juce::Graphics& g)
 {
     using namespace juce;
 
+    // the OS can repaint us before the scheduler catches up, e.g. after
+    // the window was minimised while parameters were being automated
+    if (dirty.exchange(false) || isStale())
+        refreshChain();
+    scheduler->clientPainted();
+
     g.fillAll(Colours::darkslategrey);
     auto respArea = getLocalBounds();
 
@@ -62,40 +83,29 @@ void RespCurveComponent::paint(juce::Graphics& g)
 
     auto w = respArea.getWidth();
 
-    auto sampleRate = audioProcessor.getSampleRate();
+    // the rate respCascade was designed for
+    auto sampleRate = respSampleRate;
     
-    std::vector<double> mags;
-    mags.resize(w);
+    std::vector<double> mags(w, 1.0), cosW(w), sinW(w), cos2W(w), sin2W(w);
 
-    for (int i = 0; i < w; i++)
+    // not prepared yet: nothing is designed, so the curve stays flat
+    if (sampleRate > 0.0)
     {
-        double mag = 1.0f;
-        auto freq = mapToLog10(double(i) / double(w), (double)20, (double)20000);
-
-        if (!respChain.isBypassed<FilterPositions::Peak>())
-            mag *= calcPeakMagnitude<NUM_PEAK_FILTERS>(respChain.get<FilterPositions::Peak>(), freq, sampleRate);
-        
-        if (!respChain.get<FilterPositions::LowCut>().isBypassed<0>())
-            mag *= respChain.get<FilterPositions::LowCut>().get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::LowCut>().isBypassed<1>())
-            mag *= respChain.get<FilterPositions::LowCut>().get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::LowCut>().isBypassed<2>())
-            mag *= respChain.get<FilterPositions::LowCut>().get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::LowCut>().isBypassed<3>())
-            mag *= respChain.get<FilterPositions::LowCut>().get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        if (!respChain.get<FilterPositions::HighCut>().isBypassed<0>())
-            mag *= respChain.get<FilterPositions::HighCut>().get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::HighCut>().isBypassed<1>())
-            mag *= respChain.get<FilterPositions::HighCut>().get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::HighCut>().isBypassed<2>())
-            mag *= respChain.get<FilterPositions::HighCut>().get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!respChain.get<FilterPositions::HighCut>().isBypassed<3>())
-            mag *= respChain.get<FilterPositions::HighCut>().get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        mags[i] = Decibels::gainToDecibels(mag);
+        for (int i = 0; i < w; i++)
+        {
+            auto freq = mapToLog10(double(i) / double(w), (double)20, (double)20000);
+            auto omega = MathConstants<double>::twoPi * freq / sampleRate;
+
+            cosW[i] = std::cos(omega);          sinW[i] = std::sin(omega);
+            cos2W[i] = std::cos(2.0 * omega);   sin2W[i] = std::sin(2.0 * omega);
+        }
+
+        kernels.cascadeMagnitudes(respCascade, cosW.data(), sinW.data(), cos2W.data(), sin2W.data(), mags.data(), w);
     }
 
+    for (auto& mag : mags)
+        mag = Decibels::gainToDecibels(mag);
+
     Path respCurve;
     const double opMin = respArea.getBottom();
     const double opMax = respArea.getY();
@@ -10,8 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
-
-#define NUM_PEAK_FILTERS 16
+#include "UIScheduler.h"
 
 struct CustomSlider : juce::Slider
 {
@@ -35,7 +34,7 @@ struct CustomSlopeBox : juce::ComboBox
 
 struct RespCurveComponent : juce::Component,
     juce::AudioProcessorParameter::Listener,
-    juce::Timer
+    UIScheduler::Client
 {
     RespCurveComponent(VxT_EQAudioProcessor&);
     ~RespCurveComponent() override;
@@ -43,22 +42,23 @@ struct RespCurveComponent : juce::Component,
     VxT_EQAudioProcessor& audioProcessor;
 
     void paint(juce::Graphics&) override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
     
     // listener
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override {};
     
-    // timer
-    void timerCallback() override;
-    juce::Atomic<bool> paramChanged{ true };
-
-    monoChain respChain;
-
-    // calc Peak
-    template<int Idx>
-    double calcPeakMagnitude(peakFilter& chain, const double freq, const double sampleRate);
-    template<>
-    double calcPeakMagnitude<0>(peakFilter& chain, const double freq, const double sampleRate);
+    // scheduler
+    juce::Component& getClientComponent() override { return *this; }
+    void renderFrame() override;
+    bool isStale() override;
+    void refreshChain();
+    juce::SharedResourcePointer<UIScheduler> scheduler;
+
+    CascadeCoeffs respCascade;
+    double respSampleRate{ 0.0 };
+    const KernelTable& kernels{ selectKernels() };
 };
 
 //==============================================================================
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "ChannelWorkerPool.h"
 
 //==============================================================================
 VxT_EQAudioProcessor::VxT_EQAudioProcessor()
@@ -90,76 +91,30 @@ void VxT_EQAudioProcessor::changeProgramName (int index, const juce::String& new
 {
 }
 
-template<int Idx, typename chainType, typename coeffType>
-inline void update(chainType& cutChain, const coeffType& cutCoeff)
+//==============================================================================
+void VxT_EQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    *cutChain.get<Idx>().coefficients = *cutCoeff[Idx];
-    cutChain.setBypassed<Idx>(false);
-}
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    kernels = &selectKernels();
 
-template<typename chainType, typename coeffType>
-inline void updateCut(chainType& cutChain, const coeffType& cutCoeff, const Slope cutSlope)
-{
-    cutChain.setBypassed<0>(true);
-    cutChain.setBypassed<1>(true);
-    cutChain.setBypassed<2>(true);
-    cutChain.setBypassed<3>(true);
+    const auto numChannels = juce::jmax(getTotalNumInputChannels(), 1);
+    channelStates.assign((size_t)numChannels, CascadeState{});
 
-    switch (cutSlope)
-    {
-        case Slope_48:
-        {
-            update<3>(cutChain, cutCoeff);
-            [[fallthrough]];
-        }
-        case Slope_36:
-        {
-            update<2>(cutChain, cutCoeff);
-            [[fallthrough]];
-        }
-        case Slope_24:
-        {
-            update<1>(cutChain, cutCoeff);
-            [[fallthrough]];
-        }
-        case Slope_12:
-        {
-            update<0>(cutChain, cutCoeff);
-            break;
-        }
-    }
-}
+    // hosts re-prepare when switching between realtime and offline renders,
+    // so realtime sessions never start threads or keep ours alive
+    const bool offlineThreads = (parallelChannels && numChannels > 1) || blockParallel;
+    if (!offlineThreads || !isNonRealtime())
+        workerPool.reset();
+    else if (workerPool == nullptr)
+        workerPool = std::make_unique<juce::SharedResourcePointer<ChannelWorkerPool>>();
 
+    blockEngine.prepare(blockParallel && isNonRealtime() ? samplesPerBlock : 0);
 
-template<int Idx>
-inline void updatePeak(peakFilter& peakChain, const coeffArray peakCoeffArray)
-{
-    // check which peaks to turn on here based on Idx
-    *peakChain.get<Idx-1>().coefficients = *peakCoeffArray[Idx-1];
-    return updatePeak<Idx - 1>(peakChain, peakCoeffArray);
+    updateCascade(sampleRate);
 
-}
-
-template<>
-inline void updatePeak<0>(peakFilter& peakChain, const coeffArray peakCoeffArray)
-{
-    
-}
-
-//==============================================================================
-void VxT_EQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
-    spec.sampleRate = sampleRate;
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
-
-    updateFilters(getChainSettings(apvts), sampleRate, leftChain);
-    updateFilters(getChainSettings(apvts), sampleRate, rightChain);
+    // every kernel does the reference's arithmetic in the same order
+    jassert(verifyKernels(*kernels, cascade) == 0.0f);
 }
 
 void VxT_EQAudioProcessor::releaseResources()
@@ -176,11 +131,10 @@ bool VxT_EQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) c
     return true;
   #else
     // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel runs its own cascade, so any layout up to maxChannels
+    // works, from mono and stereo to ambisonic and multichannel stems.
+    const auto numChannels = layouts.getMainOutputChannelSet().size();
+    if (numChannels < 1 || numChannels > maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -204,19 +158,74 @@ void VxT_EQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce:
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    updateFilters(getChainSettings(apvts), getSampleRate(), leftChain);
-    updateFilters(getChainSettings(apvts), getSampleRate(), rightChain);
-    
-    juce::dsp::AudioBlock<float> block(buffer);
-    auto leftBlock = block.getSingleChannelBlock(Channels::left);
-    auto rightBlock = block.getSingleChannelBlock(Channels::right);
+    updateCascade(getSampleRate());
+
+    const auto numChannels = juce::jmin(totalNumInputChannels, (int)channelStates.size());
+    const auto numSamples = buffer.getNumSamples();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+
+    auto processChannel = [&](int ch)
+    {
+        kernels->processCascade(cascade, channelStates[(size_t)ch], channels[ch], numSamples);
+        channelStates[(size_t)ch].snapToZero();
+    };
+
+    if (shouldProcessBlockParallel(numChannels, numSamples))
+    {
+        for (int ch = 0; ch < numChannels; ch++)
+        {
+            auto& state = channelStates[(size_t)ch];
+            if (!blockEngine.process(*kernels, cascade, state, channels[ch], numSamples, &workerPool->getObject()))
+                kernels->processCascade(cascade, state, channels[ch], numSamples);
+            state.snapToZero();
+        }
+        return;
+    }
+
+    if (shouldProcessInParallel(numChannels, numSamples) && (*workerPool)->tryRun(numChannels, processChannel))
+        return;
+
+    for (int ch = 0; ch < numChannels; ch++)
+        processChannel(ch);
+}
+
+bool VxT_EQAudioProcessor::shouldProcessInParallel(int numChannels, int numSamples) const
+{
+    // a realtime callback can't afford to wait on a worker that got
+    // descheduled, so this only ever engages for offline renders
+    if (!parallelChannels || workerPool == nullptr || numChannels < 2 || !isNonRealtime())
+        return false;
+
+    // spreading the block over n threads saves (1 - 1/n) of its cost, which
+    // has to outweigh handing it out. Twice the measured dispatch cost, as
+    // the channels never finish at quite the same time.
+    const auto numThreads = juce::jmin(numChannels, (*workerPool)->getNumWorkers() + 1);
+    const auto costUs = kernels->nsPerStageSample * cascade.numStages * numSamples * numChannels / 1000.0;
+    return costUs * (1.0 - 1.0 / numThreads) > 2.0 * (*workerPool)->getDispatchCostUs();
+}
 
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+bool VxT_EQAudioProcessor::shouldProcessBlockParallel(int numChannels, int numSamples) const
+{
+    // the engine is only prepared by an offline prepareToPlay after
+    // setBlockParallel(true); until then the channels stay parallel
+    if (!blockParallel || workerPool == nullptr || !isNonRealtime()
+        || !blockEngine.canProcess(numSamples))
+        return false;
 
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    // chunking does about twice the serial work, so it needs more than twice
+    // the threads splitting the channels would keep busy to come out ahead
+    const auto numThreads = (*workerPool)->getNumWorkers() + 1;
+    return parallelChannels ? 2 * numChannels < numThreads : numThreads > 2;
+}
 
+void VxT_EQAudioProcessor::setParallelChannels(bool shouldBeEnabled)
+{
+    parallelChannels = shouldBeEnabled;
+}
+
+void VxT_EQAudioProcessor::setBlockParallel(bool shouldBeEnabled)
+{
+    blockParallel = shouldBeEnabled;
 }
 
 //==============================================================================
@@ -232,32 +241,116 @@ juce::AudioProcessorEditor* VxT_EQAudioProcessor::createEditor()
 }
 
 //==============================================================================
+// compact state: magic, version, count, then count x (paramID hash, plain value)
+static constexpr int stateMagic = 0x51457856; // "VxEQ"
+static constexpr int stateVersion = 1;
+
 void VxT_EQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    const auto& params = getParameters();
+
+    mos.writeInt(stateMagic);
+    mos.writeInt(stateVersion);
+    mos.writeInt(params.size());
+    for (auto* param : params)
+    {
+        auto* ranged = static_cast<juce::RangedAudioParameter*>(param);
+        mos.writeInt(ranged->paramID.hashCode());
+        mos.writeFloat(ranged->convertFrom0to1(ranged->getValue()));
+    }
 }
 
 void VxT_EQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+    // Nothing is designed here: the sample rate may not be known yet, and the
+    // next prepareToPlay or block picks the new settings up anyway.
+    juce::MemoryInputStream mis(data, (size_t)sizeInBytes, false);
+
+    if (sizeInBytes >= 12 && mis.readInt() == stateMagic)
+    {
+        if (mis.readInt() > stateVersion)
+            return;
+
+        const auto& params = getParameters();
+        for (auto count = mis.readInt(); count > 0 && mis.getNumBytesRemaining() >= 8; count--)
+        {
+            const auto idHash = mis.readInt();
+            const auto value = mis.readFloat();
+
+            // unknown ids are skipped, missing ones keep their current value
+            for (auto* param : params)
+            {
+                auto* ranged = static_cast<juce::RangedAudioParameter*>(param);
+                if (ranged->paramID.hashCode() == idHash)
+                {
+                    ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    // sessions saved before the compact format
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid())
-    {
         apvts.replaceState(tree);
-        updateFilters(getChainSettings(apvts), getSampleRate(), leftChain);
-        updateFilters(getChainSettings(apvts), getSampleRate(), rightChain);
-    }
 }
 
-inline void updateFilters(const ChainSettings& s, const double sampleRate, monoChain& chain)
+void VxT_EQAudioProcessor::updateCascade(double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        return;
+
+    auto s = getChainSettings(apvts);
+    if (sampleRate == designedSampleRate && s == designedSettings)
+        return;
+
+    designCascade(s, sampleRate, cascade);
+    designedSettings = s;
+    designedSampleRate = sampleRate;
+}
+
+static void setStage(CascadeCoeffs& out, const int stage, const juce::dsp::IIR::Coefficients<float>& c)
+{
+    // normalised: b0, b1, b2, a1, a2 for second order, b0, b1, a1 for first
+    auto* k = c.getRawCoefficients();
+    const bool secondOrder = c.getFilterOrder() == 2;
+
+    out.b0[stage] = k[0];
+    out.b1[stage] = k[1];
+    out.b2[stage] = secondOrder ? k[2] : 0.0f;
+    out.a1[stage] = secondOrder ? k[3] : k[2];
+    out.a2[stage] = secondOrder ? k[4] : 0.0f;
+}
+
+template<typename coeffType>
+inline void setCut(CascadeCoeffs& out, const int firstStage, const coeffType& cutCoeff, const Slope cutSlope)
 {
+    // one section per 12 dB/Oct, the remaining stages stay identity
+    for (int i = 0; i <= cutSlope; i++)
+        setStage(out, firstStage + i, *cutCoeff[i]);
+}
+
+void designCascade(const ChainSettings& s, const double sampleRate, CascadeCoeffs& out)
+{
+    out.clear();
+
+    // an empty cascade passes everything through; designing at 0 Hz would
+    // never get the peak frequencies below Nyquist
+    if (sampleRate <= 0.0)
+    {
+        jassertfalse;
+        return;
+    }
+
     //apply peak
-    coeffArray peakCoeffs;
     for (int i = 0; i < 16; i++)
     {
         auto f = s.peakF * (i + 1);
@@ -268,34 +361,21 @@ inline void updateFilters(const ChainSettings& s, const double sampleRate, monoC
         while (f > sampleRate / 2)
             f -= sampleRate / 2;
 
-
-        peakCoeffs.push_back(
-            juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-                sampleRate, f, s.peakQ, g));
+        setStage(out, CascadeStages::PeakStage + i,
+            *juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, f, s.peakQ, g));
     }
-    updatePeak<16>(
-        chain.get<FilterPositions::Peak>(),
-        peakCoeffs
-    );
-
 
     //apply lowcut
     auto lowCutCoeff = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
         s.lowCutF, sampleRate, (s.lowCutSlope + 1) * 2);
-    updateCut(
-        chain.get<FilterPositions::LowCut>(),
-        lowCutCoeff,
-        static_cast<Slope>(s.lowCutSlope)
-    );
+    setCut(out, CascadeStages::LowCutStage, lowCutCoeff, s.lowCutSlope);
 
     //apply highcut
     auto highCutCoeff = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
         s.highCutF, sampleRate, (s.highCutSlope + 1) * 2);
-    updateCut(
-        chain.get<FilterPositions::HighCut>(),
-        highCutCoeff,
-        static_cast<Slope>(s.highCutSlope)
-    );
+    setCut(out, CascadeStages::HighCutStage, highCutCoeff, s.highCutSlope);
+
+    out.numStages = CascadeStages::NumCascadeStages;
 }
 
 
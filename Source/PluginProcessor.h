@@ -9,16 +9,13 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DspKernels.h"
+#include "BlockParallelCascade.h"
 
-using filter = juce::dsp::IIR::Filter<float>;
-using cutFilter = juce::dsp::ProcessorChain<filter, filter, filter, filter>;
-using peakFilter = juce::dsp::ProcessorChain<
-    filter, filter, filter, filter, filter, filter, filter, filter,
-    filter, filter, filter, filter, filter, filter, filter, filter
-    >;
-using monoChain = juce::dsp::ProcessorChain<cutFilter, cutFilter, peakFilter>;
-enum FilterPositions { LowCut, HighCut, Peak };
-using coeffArray = std::vector<juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>>>;
+class ChannelWorkerPool;
+
+// stage layout of the flattened cascade, in processing order
+enum CascadeStages { LowCutStage = 0, HighCutStage = 4, PeakStage = 8, NumCascadeStages = 24 };
 
 enum Slope {
     Slope_12,
@@ -31,18 +28,19 @@ struct ChainSettings {
     float lowCutF{ 0 };     Slope lowCutSlope{ Slope::Slope_24 };
     float highCutF{ 0 };    Slope highCutSlope{ Slope::Slope_24 };
     float peakF{ 0 };       float peakGain{ 0 };        float peakQ{ 1.0f };
+
+    bool operator==(const ChainSettings& o) const
+    {
+        return lowCutF == o.lowCutF && lowCutSlope == o.lowCutSlope
+            && highCutF == o.highCutF && highCutSlope == o.highCutSlope
+            && peakF == o.peakF && peakGain == o.peakGain && peakQ == o.peakQ;
+    }
+    bool operator!=(const ChainSettings& o) const { return !(*this == o); }
 };
 
 ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
 
-template<typename chainType, typename coeffType>
-    void updateCut(chainType& cutChain, const coeffType& cutCoeff, const Slope cutSlope);
-template<int Idx>
-    void updatePeak(peakFilter& peakChain, const coeffArray peakCoeffArray);
-template<int Idx, typename chainType, typename coeffType>
-    void update(chainType& cutChain, const coeffType& cutCoeff);
-void updateFilters(const ChainSettings& s, const double sampleRate, monoChain& chain);
-
+void designCascade(const ChainSettings& s, const double sampleRate, CascadeCoeffs& out);
 
 //==============================================================================
 /**
@@ -95,12 +93,38 @@ public:
     juce::AudioProcessorValueTreeState apvts{ 
         *this, nullptr, "Parameters", createParameterLayout() };
 
+    // lets offline renders spread the channels over a worker pool shared by
+    // every instance; the pool is created by the next offline prepareToPlay
+    void setParallelChannels(bool shouldBeEnabled);
+
+    // lets offline renders split long blocks of the same channel into chunks
+    // processed in parallel, see BlockParallelCascade. Off by default since
+    // the output is close to, but not bit-identical with, the serial path.
+    // Takes effect at the next offline prepareToPlay.
+    void setBlockParallel(bool shouldBeEnabled);
+
+    static constexpr int maxChannels = 64;
+
 
 private:
     // VxT EQ Private
-    
-    monoChain leftChain, rightChain;
-    enum Channels {left=0, right=1};
+
+    // designed lazily, on the first prepareToPlay or block that needs it,
+    // and again only when the settings or the sample rate change
+    void updateCascade(double sampleRate);
+    CascadeCoeffs cascade;
+    ChainSettings designedSettings;
+    double designedSampleRate{ 0.0 };
+
+    std::vector<CascadeState> channelStates;
+    const KernelTable* kernels{ &getScalarKernels() };
+
+    bool shouldProcessInParallel(int numChannels, int numSamples) const;
+    std::atomic<bool> parallelChannels{ true };
+    bool shouldProcessBlockParallel(int numChannels, int numSamples) const;
+    std::atomic<bool> blockParallel{ false };
+    BlockParallelCascade blockEngine;
+    std::unique_ptr<juce::SharedResourcePointer<ChannelWorkerPool>> workerPool;
 
 
     //==============================================================================
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    UIScheduler.cpp
+
+  ==============================================================================
+*/
+
+#include "UIScheduler.h"
+
+UIScheduler::~UIScheduler()
+{
+    cancelPendingUpdate();
+    vblank.reset();
+}
+
+void UIScheduler::addClient(Client& c)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    clients.addIfNotAlreadyThere(&c);
+    triggerAsyncUpdate();
+}
+
+void UIScheduler::removeClient(Client& c)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    clients.removeFirstMatchingValue(&c);
+
+    if (anchor == &c.getClientComponent())
+    {
+        vblank.reset();
+        anchor = nullptr;
+    }
+    triggerAsyncUpdate();
+}
+
+void UIScheduler::clientVisibilityChanged()
+{
+    triggerAsyncUpdate();
+}
+
+void UIScheduler::clientPainted()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    if (vblank == nullptr)
+        triggerAsyncUpdate();
+}
+
+void UIScheduler::requestFrame(Client& c)
+{
+    // the vblank is already running whenever the client can be drawn, and
+    // every request until its next frame is coalesced into the flag
+    c.dirty = true;
+}
+
+bool UIScheduler::canRender(Client& c)
+{
+    auto& comp = c.getClientComponent();
+
+    if (!comp.isShowing() || comp.getPeer() == nullptr || comp.getLocalBounds().isEmpty())
+        return false;
+
+    // fully clipped by its window, e.g. scrolled out of view
+    auto* top = comp.getTopLevelComponent();
+    return top->getLocalArea(&comp, comp.getLocalBounds()).intersects(top->getLocalBounds());
+}
+
+UIScheduler::Client* UIScheduler::findAnchor() const
+{
+    Client* found = nullptr;
+
+    for (auto* c : clients)
+    {
+        if (!canRender(*c))
+            continue;
+        // keep the current attachment if it is still usable
+        if (anchor == &c->getClientComponent())
+            return c;
+        if (found == nullptr)
+            found = c;
+    }
+    return found;
+}
+
+bool UIScheduler::hasPendingWork() const
+{
+    for (auto* c : clients)
+        if (c->dirty.load() && canRender(*c))
+            return true;
+    return false;
+}
+
+void UIScheduler::handleAsyncUpdate()
+{
+    auto* next = findAnchor();
+    if (next == nullptr)
+    {
+        vblank.reset();
+        anchor = nullptr;
+        return;
+    }
+
+    if (vblank == nullptr || anchor != &next->getClientComponent())
+    {
+        anchor = &next->getClientComponent();
+        vblank = std::make_unique<juce::VBlankAttachment>(anchor.getComponent(), [this] { onVBlank(); });
+        lastVBlankMs = 0.0;
+        vblankCount = 0;
+    }
+}
+
+void UIScheduler::onVBlank()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes();
+    const auto intervalMs = lastVBlankMs > 0.0 ? now - lastVBlankMs : refreshMs;
+    lastVBlankMs = now;
+
+    // display period: follow faster intervals at once, slower ones slowly
+    refreshMs = juce::jmin(intervalMs, refreshMs + 0.01 * (intervalMs - refreshMs));
+
+    // the anchor went away: re-attach or detach outside the callback
+    if (anchor == nullptr || !anchor->isShowing())
+    {
+        triggerAsyncUpdate();
+        return;
+    }
+
+    for (auto* c : clients)
+        if (c->isStale())
+            c->dirty = true;
+
+    if (!hasPendingWork() || ++vblankCount < frameDivider)
+        return;
+    vblankCount = 0;
+
+    for (auto* c : clients)
+    {
+        // hidden clients stay dirty and are served once they show again
+        if (!c->dirty.load() || !canRender(*c))
+            continue;
+
+        c->dirty = false;
+        c->renderFrame();
+    }
+
+    adaptFrameRate(intervalMs, juce::Time::getMillisecondCounterHiRes() - now);
+}
+
+void UIScheduler::adaptFrameRate(double intervalMs, double workMs)
+{
+    avgIntervalMs += 0.1 * (intervalMs - avgIntervalMs);
+    avgWorkMs     += 0.1 * (workMs - avgWorkMs);
+
+    if (++framesSinceAdapt < 30)
+        return;
+
+    // late vblanks mean the message thread is busy elsewhere,
+    // long frames mean we are the ones keeping it busy
+    const auto budgetMs = refreshMs * frameDivider;
+    const bool overloaded = avgIntervalMs > refreshMs * 1.5 || avgWorkMs > budgetMs * 0.5;
+    const bool relaxed = avgIntervalMs < refreshMs * 1.2 && avgWorkMs < budgetMs * 0.15;
+
+    if (overloaded && frameDivider < maxFrameDivider)
+        ++frameDivider;
+    else if (relaxed && frameDivider > 1)
+        --frameDivider;
+    else
+        return;
+
+    framesSinceAdapt = 0;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    UIScheduler.h
+
+    Process-wide frame scheduler shared by every open editor. One
+    VBlankAttachment drives all clients and lives as long as any of them is
+    on screen, so a redraw request only has to set a flag; vblanks with
+    nothing dirty return at once. Requests come from the audio thread, which
+    can't wake the message thread safely, so an idle but visible editor
+    keeps that cheap callback rather than detaching. Once no client is
+    showing the attachment is dropped and no callbacks run.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class UIScheduler : private juce::AsyncUpdater
+{
+public:
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        virtual juce::Component& getClientComponent() = 0;
+        // called on the message thread, at most once per served frame
+        virtual void renderFrame() = 0;
+        // polled on the message thread every vblank, for changes nothing
+        // requests a frame for; returning true marks the client dirty
+        virtual bool isStale() { return false; }
+
+        // coalesces any number of requests between two frames
+        std::atomic<bool> dirty{ true };
+    };
+
+    UIScheduler() = default;
+    ~UIScheduler() override;
+
+    // message thread
+    void addClient(Client&);
+    void removeClient(Client&);
+    void clientVisibilityChanged();
+    // restoring a minimised window fires no visibility callbacks, but it
+    // does repaint, so clients call this from paint() to re-attach
+    void clientPainted();
+
+    // any thread, including the audio thread: only sets the client's flag,
+    // no locks, allocations or messages
+    void requestFrame(Client&);
+
+    // 1 = every vblank, 2 = every other vblank, ...
+    int getFrameDivider() const noexcept { return frameDivider; }
+
+private:
+    void handleAsyncUpdate() override;
+    void onVBlank();
+    void adaptFrameRate(double intervalMs, double workMs);
+
+    static bool canRender(Client&);
+    Client* findAnchor() const;
+    bool hasPendingWork() const;
+
+    juce::Array<Client*> clients;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    juce::Component::SafePointer<juce::Component> anchor;
+
+    // adaptive rate
+    static constexpr int maxFrameDivider = 4;
+    int frameDivider{ 1 }, vblankCount{ 0 }, framesSinceAdapt{ 0 };
+    double lastVBlankMs{ 0.0 }, refreshMs{ 1000.0 / 60.0 };
+    double avgIntervalMs{ 1000.0 / 60.0 }, avgWorkMs{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UIScheduler)
+};